@@ -19,6 +19,9 @@
 #include <string>
 #include <vector>
 
+#include "oofcanvas/exportjob.h"
+#include "oofcanvas/sceneedits.h"
+
 namespace OOFCanvas {
   class CanvasLayer;
   class OSCanvasImpl;
@@ -26,7 +29,12 @@ namespace OOFCanvas {
   class ICoord;
   class Coord;
   class CanvasItem;
-  
+  class CanvasShape;
+  class CanvasFillableShape;
+  class CanvasMarkers;
+  class CanvasScalarImage;
+  class MemoryStats;
+
 
   class OffScreenCanvas {
   protected:
@@ -40,6 +48,8 @@ namespace OOFCanvas {
     const OSCanvasImpl *getCanvas() const { return osCanvasImpl; }
 
     CanvasLayer *newLayer(const std::string&);
+    CanvasLayer *newLayerView(const std::string&, CanvasLayer*);
+    void addLayerViews(const OffScreenCanvas&);
     void deleteLayer(CanvasLayer*);
     CanvasLayer *getLayer(int) const;
     CanvasLayer *getLayer(const std::string&) const;
@@ -53,11 +63,34 @@ namespace OOFCanvas {
     void clear();
     void draw();
 
+    // Changes made between beginUpdate and endUpdate are drawn once,
+    // when the outermost endUpdate is called.  CanvasUpdate, below,
+    // makes sure that endUpdate is called.
+    void beginUpdate();
+    void endUpdate();
+
+    // The post methods are thread safe and don't block.  The edits
+    // are applied in order at the start of the next frame or export,
+    // or by applySceneEdits().  See OSCanvasImpl::postEdit.
+    void postEdit(const SceneEdit&);
+    void postAddItem(CanvasLayer*, CanvasItem*);
+    void postRemoveItem(CanvasLayer*, CanvasItem*);
+    void postSetLineColor(CanvasShape*, const Color&);
+    void postSetFillColor(CanvasFillableShape*, const Color&);
+    void postSetPoints(CanvasMarkers*, std::vector<double>&&,
+		       std::vector<double>&&);
+    void postSetValues(CanvasScalarImage*, std::vector<double>&&);
+    std::size_t applySceneEdits();
+
     double getPixelsPerUnit() const;
     ICoord user2pixel(const Coord&) const;
     Coord pixel2user(const ICoord&) const;
     double user2pixel(double) const;
     double pixel2user(double) const;
+    // Convert n points stored as x0, y0, x1, y1, ...  The input and
+    // output arrays may be the same.  See OSCanvasImpl::user2pixels.
+    void user2pixels(const double *in, double *out, std::size_t n) const;
+    void pixels2user(const double *in, double *out, std::size_t n) const;
 
     void setAntialias(bool);
     void setMargin(double);
@@ -73,11 +106,54 @@ namespace OOFCanvas {
     bool saveAsPNG(const std::string &filename, int, bool);
     bool saveRegionAsPNG(const std::string &filename, int, bool,
 			 const Coord&, const Coord&);
+    bool saveAsBandedPNG(const std::string &filename, int, bool, int);
+    bool saveRegionAsBandedPNG(const std::string &filename, int, bool,
+			       const Coord&, const Coord&, int);
+
+    // The Async versions return immediately and save the image on
+    // another thread.  The callbacks may be null.  The caller owns
+    // the returned ExportJob.
+    ExportJob *saveAsPDFAsync(const std::string &filename, int, bool,
+			      ExportProgressCallback, ExportDoneCallback,
+			      void*);
+    ExportJob *saveAsPNGAsync(const std::string &filename, int, bool,
+			      ExportProgressCallback, ExportDoneCallback,
+			      void*);
+    ExportJob *saveRegionAsPDFAsync(const std::string &filename, int, bool,
+				    const Coord&, const Coord&,
+				    ExportProgressCallback, ExportDoneCallback,
+				    void*);
+    ExportJob *saveRegionAsPNGAsync(const std::string &filename, int, bool,
+				    const Coord&, const Coord&,
+				    ExportProgressCallback, ExportDoneCallback,
+				    void*);
 
     std::vector<CanvasItem*> clickedItems(const Coord&) const;
     std::vector<CanvasItem*> allItems() const;
 
     void datadump(const std::string &filename) const;
+
+    void saveScene(const std::string &filename) const;
+    void loadScene(const std::string &filename);
+
+    MemoryStats getMemoryStats() const;
+    void setSurfacePoolBudget(std::size_t);
+    void setHiddenLayerBudget(std::size_t);
+
+    friend class FrameExporter;
+  };
+
+  // A CanvasUpdate calls beginUpdate on the canvas when it's created
+  // and endUpdate when it's destroyed.
+
+  class CanvasUpdate {
+  private:
+    OffScreenCanvas &canvas;
+  public:
+    CanvasUpdate(OffScreenCanvas&);
+    ~CanvasUpdate();
+    CanvasUpdate(const CanvasUpdate&) = delete;
+    CanvasUpdate &operator=(const CanvasUpdate&) = delete;
   };
 
 };				// namespace OOFCanvas
@@ -0,0 +1,133 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_CELLGRID_H
+#define OOFCANVAS_CELLGRID_H
+
+#include "oofcanvas/canvasshape.h"
+#include "oofcanvas/utility.h"
+#include <cstdint>
+#include <vector>
+
+namespace OOFCanvas {
+
+  // A CanvasCellGrid draws a rectilinear grid of rectangular cells,
+  // such as a structured mesh, as a single item.  The cell
+  // boundaries are given by increasing lists of x and y coordinates.
+  // Cell (i, j) lies between xs[i] and xs[i+1] and between ys[j] and
+  // ys[j+1], so j counts up from the bottom.
+
+  // Each cell has a value, which is mapped to a color through a
+  // colormap, or it has an explicit color.  Cells whose values are
+  // NaN aren't drawn.  Grid lines are drawn with the CanvasShape line
+  // style, so by default there aren't any.
+
+  // Only the visible cells are drawn.  When the cells are smaller
+  // than rasterThreshold pixels, they're drawn into an image at the
+  // display resolution, and grid lines are omitted.  Otherwise each
+  // cell is a rectangle.
+
+  class CanvasCellGrid : public CanvasShape {
+  protected:
+    std::vector<double> xs, ys;	// cell boundaries
+    bool uniformX, uniformY;	// are the boundaries evenly spaced?
+    std::vector<float> values;	// ordered by rows, bottom row first
+    // Explicit cell colors, packed as 8 bit RGBA values, red in the
+    // high byte.  If colors is empty, the values are used.
+    std::vector<std::uint32_t> colors;
+    std::vector<Color> colormap;
+    double vmin, vmax;
+    double rasterThreshold;
+    unsigned long dataVersion;
+    unsigned long mapVersion;
+    void setEdges(const double*, std::size_t, const double*, std::size_t);
+    void dataChanged();
+    void mapChanged();
+    std::size_t index(int i, int j) const {
+      return std::size_t(j)*(xs.size()-1) + i;
+    }
+  public:
+    // Create a grid of n.x by n.y cells of the given size, with its
+    // lower left corner at origin.
+    CanvasCellGrid(const Coord &origin, const Coord &cellSize,
+		   const ICoord &n);
+    // Create a grid with the given cell boundaries.
+    CanvasCellGrid(const std::vector<double> &xs,
+		   const std::vector<double> &ys);
+    CanvasCellGrid(const CanvasCellGrid&) = delete;
+    static CanvasCellGrid *create(const Coord *origin, const Coord *cellSize,
+				  const ICoord *n)
+    {
+      return new CanvasCellGrid(*origin, *cellSize, *n);
+    }
+    static CanvasCellGrid *createRectilinear(const std::vector<double> *xs,
+					     const std::vector<double> *ys)
+    {
+      return new CanvasCellGrid(*xs, *ys);
+    }
+    virtual const std::string &classname() const;
+
+    int nx() const { return xs.size() - 1; }
+    int ny() const { return ys.size() - 1; }
+    const std::vector<double> &getXs() const { return xs; }
+    const std::vector<double> &getYs() const { return ys; }
+
+    // setValues copies nx()*ny() values from the given array.
+    void setValues(const float*);
+    void setValues(const double*);
+    void setValues(const std::vector<double>*);
+    void setValue(const ICoord&, double);
+    void setValue(const ICoord *cell, double v) { setValue(*cell, v); }
+    double getValue(const ICoord&) const;
+    double getValue(const ICoord *cell) const { return getValue(*cell); }
+
+    // setColors gives each cell its own color, overriding the values.
+    // An empty vector goes back to using the values.
+    void setColors(const std::vector<Color>*);
+    void setColor(const ICoord&, const Color&);
+    void setColor(const ICoord *cell, const Color &c) { setColor(*cell, c); }
+    Color getColor(const ICoord&) const;
+
+    // The colormap is a list of evenly spaced colors.  The first is
+    // used for vmin and the last for vmax.  The default is a gray
+    // scale from black to white.
+    void setColormap(const std::vector<Color>&);
+    const std::vector<Color> &getColormap() const { return colormap; }
+    void setRange(double vmin, double vmax);
+    void autoRange();
+    double getMin() const { return vmin; }
+    double getMax() const { return vmax; }
+
+    // Cells smaller than this many pixels, on average, are drawn as
+    // an image.  The default is 2.
+    void setRasterThreshold(double pixels);
+    double getRasterThreshold() const { return rasterThreshold; }
+
+    // findCell finds the cell containing the given point, and returns
+    // false if the point isn't in the grid.  It takes constant time
+    // on an evenly spaced grid.  The pointer version returns a new
+    // ICoord, or nullptr if the point isn't in the grid.
+    bool findCell(const Coord&, ICoord&) const;
+    ICoord *findCell(const Coord*) const;
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasCellGrid&);
+    virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasCellGridImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasCellGrid&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_CELLGRID_H
@@ -37,6 +37,8 @@ namespace OOFCanvas {
     void setCenter(const Coord&);
     friend std::ostream &operator<<(std::ostream&, const CanvasCircle&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
   std::ostream &operator<<(std::ostream&, const CanvasCircle&);
 
@@ -64,6 +66,8 @@ namespace OOFCanvas {
     double getAngleRadians() const { return angle; }
     friend std::ostream &operator<<(std::ostream&, const CanvasEllipse&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
   std::ostream &operator<<(std::ostream&, const CanvasEllipse&);
 
@@ -86,6 +90,8 @@ namespace OOFCanvas {
     double getRadius() const { return radius; }
     friend std::ostream &operator<<(std::ostream&, const CanvasDot&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
   std::ostream &operator<<(std::ostream&, const CanvasDot&);
 
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_CONTOURS_H
+#define OOFCANVAS_CONTOURS_H
+
+#include "oofcanvas/canvasshape.h"
+#include "oofcanvas/utility.h"
+#include <vector>
+
+namespace OOFCanvas {
+
+  class CanvasScalarImage;
+
+  // CanvasContours draws contour lines of a scalar field that's
+  // sampled on a regular grid of points.  Point (i, j) is at origin +
+  // (i*spacing.x, j*spacing.y), so j counts up from the bottom.  The
+  // lines are drawn with the CanvasShape line style.  The default
+  // line width is one pixel.
+
+  // The contours are computed when they're first drawn, with the
+  // marching squares algorithm, and are stored as line segments.
+  // Changing the levels only recomputes the levels that are new.
+  // Changing the values recomputes all of them.
+
+  class CanvasContours : public CanvasShape {
+  protected:
+    Coord origin;
+    Coord spacing;
+    ICoord npts;		// number of points in each direction
+    std::vector<float> values;	// ordered by rows, bottom row first
+    std::vector<double> levels;
+    unsigned long dataVersion;
+    void dataChanged();
+  public:
+    CanvasContours(const Coord &origin, const Coord &spacing,
+		   const ICoord &npts);
+    CanvasContours(const CanvasContours&) = delete;
+    static CanvasContours *create(const Coord *origin, const Coord *spacing,
+				  const ICoord *npts)
+    {
+      return new CanvasContours(*origin, *spacing, *npts);
+    }
+    // Create contours for the values in a CanvasScalarImage, sampled
+    // at the centers of its pixels.  The levels aren't copied.
+    static CanvasContours *fromScalarImage(const CanvasScalarImage*);
+    virtual const std::string &classname() const;
+
+    const ICoord &getSizeInPoints() const { return npts; }
+
+    // setValues copies npts.x*npts.y values from the given array.
+    // Values that are NaN are holes in the field.
+    void setValues(const float*);
+    void setValues(const double*);
+    void setValues(const std::vector<double>*);
+    void setValue(const ICoord&, double);
+    void setValue(const ICoord *pt, double v) { setValue(*pt, v); }
+    double getValue(const ICoord&) const;
+    double getValue(const ICoord *pt) const { return getValue(*pt); }
+
+    void setLevels(const std::vector<double>*);
+    void addLevel(double);
+    void clearLevels();
+    const std::vector<double> &getLevels() const { return levels; }
+
+    // Return the number of line segments in the contour at the given
+    // level index, computing it if necessary.
+    std::size_t segmentCount(int level) const;
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasContours&);
+    virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasContoursImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasContours&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_CONTOURS_H
@@ -0,0 +1,98 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_GROUP_H
+#define OOFCANVAS_GROUP_H
+
+#include "oofcanvas/canvasitem.h"
+#include "oofcanvas/utility.h"
+#include <memory>
+#include <vector>
+
+namespace OOFCanvas {
+
+  class CanvasGroupContents;
+  class CanvasGroupImplementation;
+
+  // A CanvasGroup draws a set of CanvasItems, its contents, more than
+  // once, each time with a different affine transformation.  Each
+  // copy is called an instance.  The items are stored once no matter
+  // how many instances there are, and several groups can share the
+  // same contents.  The group owns its contents, which are deleted
+  // when the last group that shares them is deleted.
+
+  // The items in a group are not in any CanvasLayer, so changing one
+  // of them doesn't mark the layer dirty.  Call contentsModified()
+  // after changing an item in a group.
+
+  class CanvasGroup : public CanvasItem {
+  protected:
+    // An instance maps the group's coordinates to user coordinates
+    // by x' = xx*x + xy*y + x0, y' = yx*x + yy*y + y0.
+    struct Instance {
+      double xx, yx, xy, yy, x0, y0;
+      Rectangle bbox;		// bare bounding box in user coordinates
+    };
+    std::shared_ptr<CanvasGroupContents> contents;
+    std::vector<Instance> instances;
+    // sameShape is true if all instances have the same xx, yx, xy,
+    // and yy, so that they differ only by translation.
+    bool sameShape;
+    void setInstanceBBox(Instance&) const;
+    void updateBBox();
+  public:
+    CanvasGroup();
+    // This constructor creates a group with the same contents as the
+    // given group, but no instances.
+    CanvasGroup(const CanvasGroup*);
+    static CanvasGroup *create() { return new CanvasGroup(); }
+    static CanvasGroup *createShared(const CanvasGroup *other) {
+      return new CanvasGroup(other);
+    }
+    virtual ~CanvasGroup();
+    virtual const std::string &classname() const;
+
+    // addItem adds an item to the contents of this group and all
+    // groups that share them.  The group takes ownership of the item.
+    void addItem(CanvasItem*);
+    void contentsModified();
+    std::size_t nItems() const;
+
+    // addInstance adds a copy of the contents, scaled by the given
+    // factor, rotated counterclockwise by the given angle in degrees,
+    // and then translated by the given offset.
+    void addInstance(const Coord &offset, double scale=1.0, double angle=0.0);
+    void addInstance(const Coord *offset, double scale, double angle) {
+      addInstance(*offset, scale, angle);
+    }
+    void addTransformedInstance(double xx, double yx, double xy, double yy,
+				double x0, double y0);
+    void clearInstances();
+    std::size_t nInstances() const { return instances.size(); }
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasGroup&);
+    virtual std::string print() const;
+
+    // The contents are saved once, with the first group that's saved,
+    // and groups that share them are still sharing them when they're
+    // loaded.
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasGroupContents;
+    friend class CanvasGroupImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasGroup&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_GROUP_H
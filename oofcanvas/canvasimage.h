@@ -110,6 +110,8 @@ namespace OOFCanvas {
 
     friend std::ostream &operator<<(std::ostream&, const CanvasImage&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
   
   std::ostream &operator<<(std::ostream&, const CanvasImage&);
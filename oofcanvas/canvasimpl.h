@@ -12,7 +12,9 @@
 #ifndef OOFCANVAS_CANVAS_H
 #define OOFCANVAS_CANVAS_H
 
+#include <atomic>
 #include <cairomm/cairomm.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,15 +24,23 @@ namespace OOFCanvas {
 
 #include "oofcanvas/canvaslayer.h"
 #include "oofcanvas/canvaslayerimpl.h"
+#include "oofcanvas/exportjob.h"
+#include "oofcanvas/sceneedits.h"
+#include "oofcanvas/surfacepool.h"
 #include "oofcanvas/utility_extra.h"
 
 
 namespace OOFCanvas {
 
+  class CanvasFillableShape;
   class CanvasItem;
   class CanvasLayer;
   class CanvasLayerImpl;
+  class CanvasMarkers;
+  class CanvasScalarImage;
+  class CanvasShape;
   class SurfaceCreator;
+  class ExportSnapshot;
 
   // OSCanvasImpl is the implementation, hidden from the user, of
   // OffScreenCanvas.  An OffScreenCanvas holds a pointer to an
@@ -39,6 +49,11 @@ namespace OOFCanvas {
 
   class OSCanvasImpl {
   protected:
+    // Layers and offscreen buffers lease their bitmaps from
+    // surfacePool, so that zooming and resizing don't free and
+    // reallocate them.  It's constructed before the backingLayer,
+    // which leases a bitmap when the canvas is constructed.
+    SurfacePool surfacePool;
     CanvasLayerImpl backingLayer;
     std::vector<CanvasLayerImpl*> layers;
     // boundingBox is the bounding box, in user coordinates, of all of
@@ -68,7 +83,57 @@ namespace OOFCanvas {
     void drawBackground(Cairo::RefPtr<Cairo::Context>) const;
     bool initialized;
 
+    // updateDepth counts nested beginUpdate calls.  Calls to draw()
+    // while it's positive are remembered in drawDeferred and carried
+    // out by the outermost endUpdate.
+    int updateDepth;
+    bool drawDeferred;
+
+    // The bitmaps of hidden layers are released, least recently
+    // hidden first, when their total size exceeds hiddenLayerBudget.
+    // Layers can be hidden without holding the canvas lock, so hiding
+    // a layer just sets hiddenLayersChanged, and trimHiddenLayers is
+    // called later from an entry point that holds the lock.
+    std::size_t hiddenLayerBudget;
+    std::atomic<unsigned long> lastHiddenStamp;
+    std::atomic<bool> hiddenLayersChanged;
+    unsigned long nextHiddenStamp() { return ++lastHiddenStamp; }
+    void trimHiddenLayers();
+
     bool saveRegion(SurfaceCreator&, int, bool, const Coord&, const Coord&);
+    // exportTransform computes the size in pixels of an exported
+    // region and the transform from user coordinates to the exported
+    // image's pixels.
+    Cairo::Matrix exportTransform(int, const Rectangle&, ICoord&) const;
+
+    // Asynchronous exports copy the drawing commands for the visible
+    // layers into an ExportSnapshot on the calling thread, and draw
+    // the snapshot on the ExportJob's thread.
+    std::shared_ptr<ExportSnapshot> snapshotRegion(int, bool, const Coord&,
+						   const Coord&) const;
+    ExportJob *startExport(bool pdf, const std::string&, int, bool,
+			   const Coord&, const Coord&,
+			   const ExportJob::ProgressFn&,
+			   const ExportJob::DoneFn&);
+    // exportCallbackPoster returns the function that ExportJobs use
+    // to run their callbacks.  The base class version returns a null
+    // function, so callbacks run on the export thread.  GUI canvases
+    // run them on the main thread.
+    virtual ExportJob::Poster exportCallbackPoster() const;
+
+    // Edits posted from other threads wait in sceneEdits until the
+    // next frame or export.  sceneEditsPosted is called, on the
+    // posting thread, when an edit is posted to an empty queue.  The
+    // base class version does nothing.  GUI canvases use it to
+    // schedule a frame.
+    SceneEditQueue sceneEdits;
+    virtual void sceneEditsPosted() {}
+
+    // viewModelChanged is called, possibly on another thread, when the
+    // model of a layer view in this canvas is in a different canvas
+    // and its contents change.  The base class version does nothing.
+    // GUI canvases use it to schedule a frame.
+    virtual void viewModelChanged() {}
 
     mutable Lock lock;
 
@@ -92,7 +157,19 @@ namespace OOFCanvas {
     // This version just exists for calling from Python.
     Coord *pixel2user(int, int) const;
 
+    // Batch conversions.  user2pixels and pixels2user convert n
+    // points, stored as x0, y0, x1, y1, ..., from in to out, which
+    // may be the same array.  Unlike user2pixel, the pixel
+    // coordinates aren't truncated to integers.  The transform is
+    // read once, so nothing is locked or allocated per point.
+    void user2pixels(const double *in, double *out, std::size_t n) const;
+    void pixels2user(const double *in, double *out, std::size_t n) const;
+    // Versions for swig take and return flat lists of numbers.
+    std::vector<double> *user2pixels_new(const std::vector<double>*) const;
+    std::vector<double> *pixels2user_new(const std::vector<double>*) const;
+
     void setAntialias(bool);
+    Cairo::Antialias getAntialias() const { return antialiasing; }
     void setMargin(double);
 
     bool empty() const;		// Is anything drawn?
@@ -100,6 +177,11 @@ namespace OOFCanvas {
     void setBackgroundColor(const Color&);
 
     CanvasLayer *newLayer(const std::string&);
+    // newLayerView creates a layer that displays the items of
+    // another layer, which may be in another canvas.  addLayerViews
+    // creates views of all of the layers of another canvas.
+    CanvasLayer *newLayerView(const std::string&, CanvasLayer*);
+    void addLayerViews(const OSCanvasImpl*);
     void deleteLayer(CanvasLayer*);
     CanvasLayer *getLayer(int i) const { return layers[i]; }
     CanvasLayer *getLayer(const std::string&) const;
@@ -117,6 +199,37 @@ namespace OOFCanvas {
     // draw method doesn't.
     virtual void draw() {}
 
+    // Changes made between beginUpdate and endUpdate are drawn once,
+    // by endUpdate, instead of after each change.  The calls can be
+    // nested.
+    void beginUpdate();
+    void endUpdate();
+    bool updating() const { return updateDepth > 0; }
+
+    // The post methods can be called from any thread without holding
+    // the canvas lock, and never wait for drawing to finish.  The
+    // edits are applied in the order in which they were posted, all
+    // at once, at the start of the next frame or export, or when
+    // applySceneEdits is called with the lock held.  A thread that
+    // posts an edit to an item must not use the item directly
+    // afterwards.
+    void postEdit(SceneEdit&&);
+    // postAddItem transfers ownership of the item to the layer.
+    void postAddItem(CanvasLayer*, CanvasItem*);
+    void postRemoveItem(CanvasLayer*, CanvasItem*);
+    void postSetLineColor(CanvasShape*, const Color&);
+    void postSetFillColor(CanvasFillableShape*, const Color&);
+    // postSetPoints moves the points of a CanvasMarkers item, and
+    // postSetValues replaces the values of a CanvasScalarImage.  The
+    // rvalue versions take the data without copying it.
+    void postSetPoints(CanvasMarkers*, std::vector<double>&&,
+		       std::vector<double>&&);
+    void postSetPoints(CanvasMarkers*, const std::vector<double>*,
+		       const std::vector<double>*);
+    void postSetValues(CanvasScalarImage*, std::vector<double>&&);
+    void postSetValues(CanvasScalarImage*, const std::vector<double>*);
+    std::size_t applySceneEdits();
+
     bool saveAsPDF(const std::string &filename, int, bool);
     bool saveRegionAsPDF(const std::string &filename, int, bool,
 			 const Coord&, const Coord&);
@@ -127,6 +240,30 @@ namespace OOFCanvas {
 			 const Coord&, const Coord&);
     bool saveRegionAsPNG(const std::string &filename, int, bool,
 			 const Coord*, const Coord*);
+    // The BandedPNG versions draw the image in bands of the given
+    // height, so that very large images can be saved.
+    bool saveAsBandedPNG(const std::string &filename, int, bool, int);
+    bool saveRegionAsBandedPNG(const std::string &filename, int, bool,
+			       const Coord&, const Coord&, int);
+    bool saveRegionAsBandedPNG(const std::string &filename, int, bool,
+			       const Coord*, const Coord*, int);
+
+    // Asynchronous versions of the save methods.  They return
+    // immediately, and the caller owns the returned ExportJob.
+    ExportJob *saveAsPDFAsync(const std::string &filename, int, bool,
+			      const ExportJob::ProgressFn&,
+			      const ExportJob::DoneFn&);
+    ExportJob *saveAsPNGAsync(const std::string &filename, int, bool,
+			      const ExportJob::ProgressFn&,
+			      const ExportJob::DoneFn&);
+    ExportJob *saveRegionAsPDFAsync(const std::string &filename, int, bool,
+				    const Coord&, const Coord&,
+				    const ExportJob::ProgressFn&,
+				    const ExportJob::DoneFn&);
+    ExportJob *saveRegionAsPNGAsync(const std::string &filename, int, bool,
+				    const Coord&, const Coord&,
+				    const ExportJob::ProgressFn&,
+				    const ExportJob::DoneFn&);
 
     std::vector<CanvasItem*> clickedItems(const Coord&) const;
     std::vector<CanvasItem*> allItems() const;
@@ -137,9 +274,26 @@ namespace OOFCanvas {
 
     void datadump(const std::string&) const;
 
+    // saveScene writes all of the layers and items to a binary file
+    // that loadScene can read.  loadScene adds the layers in the file
+    // to the canvas, above any existing layers.
+    void saveScene(const std::string&) const;
+    void loadScene(const std::string&);
+
+    // getMemoryStats returns the total memory used by the layers'
+    // bitmaps and caches, including internal layers.
+    virtual MemoryStats getMemoryStats() const;
+    // setSurfacePoolBudget sets the number of bytes of idle bitmaps
+    // that are kept for reuse.
+    void setSurfacePoolBudget(std::size_t);
+    // setHiddenLayerBudget sets the number of bytes that the bitmaps
+    // of hidden layers may use.
+    void setHiddenLayerBudget(std::size_t);
+
     friend class OffScreenCanvas;
     friend class CanvasLayerImpl;
     friend class CanvasItem;
+    friend class FrameExporterImpl;
   };				// OSCanvasImpl
 
   //=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//
@@ -168,6 +322,30 @@ namespace OOFCanvas {
     virtual Cairo::RefPtr<Cairo::Surface> create(int, int);
     void saveAsPNG(const std::string&);
   };
+
+  // ExportSnapshot holds recordings of the visible layers, made in the
+  // coordinates of the exported image, and everything else needed to
+  // export them.  It doesn't refer to the OSCanvasImpl, so it can be
+  // used on another thread while the canvas is being changed or
+  // after it's been deleted.
+
+  class ExportSnapshot {
+  public:
+    struct Layer {
+      Cairo::RefPtr<Cairo::Surface> recording;
+      double alpha;
+      LayerFormat format;
+      Color tint;
+    };
+    ICoord size;		// size of the image in pixels
+    bool drawBG;
+    Color bgColor;
+    Cairo::Antialias antialias;
+    std::vector<Layer> layers;
+    void draw(Cairo::RefPtr<Cairo::Context>, ExportJob&) const;
+    bool writePNG(const std::string&, ExportJob&) const;
+    bool writePDF(const std::string&, ExportJob&) const;
+  };
   
 };				// namespace OOFCanvas
 
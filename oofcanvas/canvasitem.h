@@ -25,6 +25,8 @@ namespace OOFCanvas {
   class CanvasItemImplBase;
   class CanvasLayer;
   class OffScreenCanvas;
+  class SceneReader;
+  class SceneWriter;
 
   class CanvasItem 
 #ifdef OOFCANVAS_USE_PYTHON
@@ -63,6 +65,13 @@ namespace OOFCanvas {
 
     virtual std::string print() const = 0;
     std::string *repr() const; // for python wrapping
+
+    // writeScene() saves the item in a binary scene file (see
+    // OffScreenCanvas::saveScene).  Each subclass that can be saved
+    // redefines it, and defines a static readScene(SceneReader&)
+    // method that SceneReader uses to recreate the item.  The
+    // default version raises an exception.
+    virtual void writeScene(SceneWriter&) const;
   };
 
   std::ostream &operator<<(std::ostream&, const CanvasItem&);
@@ -18,11 +18,13 @@
 
 #include "oofcanvas/utility_extra.h"
 #include <cairomm/cairomm.h>
+#include <mutex>
 
 namespace OOFCanvas {
 
   class OSCanvasImpl;
   class CanvasLayer;
+  class CanvasShapeStyle;
 
   class CanvasItemImplBase {
   private:
@@ -30,6 +32,12 @@ namespace OOFCanvas {
     template <class T> friend class CanvasItemImplementation;
     CanvasItemImplBase(const Rectangle&); // arg is the bare bounding box
     CanvasLayer *layer;
+    mutable Cairo::Path *cachedPath; // see replayPath()
+    // An item can be drawn on more than one thread at once, for
+    // example by layer views in different canvases, so access to
+    // cachedPath is serialized.  The locks are shared by many items,
+    // to keep the items small.
+    std::mutex &pathLock() const;
 
   public:
     virtual ~CanvasItemImplBase();
@@ -43,6 +51,31 @@ namespace OOFCanvas {
     void draw(Cairo::RefPtr<Cairo::Context>) const;
     virtual void drawItem(Cairo::RefPtr<Cairo::Context>) const = 0;
 
+    // Items that are drawn by constructing a single path and filling
+    // and/or stroking it with a CanvasShapeStyle can be drawn in
+    // batches.  CanvasLayerImpl::renderToContext draws consecutive
+    // items with the same style by calling replayPath() for each of
+    // them and applying the style once, instead of calling draw().
+    // batchStyle() returns the item's style if it can be batched, or
+    // nullptr if it can't.  appendPath() adds the item's path to the
+    // context's current path without drawing it.
+    virtual const CanvasShapeStyle *batchStyle() const { return nullptr; }
+    virtual void appendPath(Cairo::RefPtr<Cairo::Context>) const {}
+
+    // replayPath() does the same thing as appendPath(), but saves a
+    // copy of the path the first time it's called and uses the copy
+    // after that.  The path is in user coordinates, so the copy can
+    // be reused after zooming.  The copy is discarded by modified().
+    // Items should call replayPath() instead of appendPath() in
+    // drawItem().
+    void replayPath(Cairo::RefPtr<Cairo::Context>) const;
+    // pathIsCacheable() must return false if the path built by
+    // appendPath() depends on the ppu, for example if it includes
+    // components whose sizes are given in pixels.
+    virtual bool pathIsCacheable() const { return true; }
+    std::size_t pathCacheBytes() const;
+    void clearPathCache() const;
+
     // drawBoundingBox is a no-op unless DEBUG is defined.
     void drawBoundingBox(double, const Color&);
 
@@ -66,6 +99,13 @@ namespace OOFCanvas {
     virtual void pixelExtents(double &left, double &right,
 			      double &up, double &down) const;
 
+    // dependsOnPPU() returns true if the item's appearance in user
+    // space changes when the ppu changes.  A layer's recording (see
+    // CanvasLayerImpl::setRecording) can't be replayed at a new ppu
+    // if any of its items depend on the ppu.  The default
+    // implementation checks pixelExtents.
+    virtual bool dependsOnPPU() const;
+
     // containsPoint computes whether the given point in user
     // coordinates is on the item.  It's used to determine if a mouse
     // click selected the item.  It's called after bounding boxes have
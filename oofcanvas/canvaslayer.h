@@ -21,6 +21,13 @@ namespace OOFCanvas {
   class Color;
   class Coord;
   class ICoord;
+  class MemoryStats;
+
+  // LayerFormat is the pixel format of a layer's bitmap.  ARGB32 is
+  // full color with transparency.  RGB24 has no transparency, and is
+  // suitable for layers that cover the whole canvas.  A8 stores only
+  // opacity, and the layer is drawn in a single tint color.
+  enum class LayerFormat {ARGB32, RGB24, A8};
 
   // CanvasLayer is an abstract base class that contains the
   // public interface for CanvasLayerImpl.
@@ -54,6 +61,9 @@ namespace OOFCanvas {
       const = 0;
 
     virtual void setOpacity(double) = 0;
+    virtual void setRecording(bool) = 0;
+    virtual void setFormat(LayerFormat) = 0;
+    virtual void setTint(const Color&) = 0;
     
     virtual void allItems(std::vector<CanvasItem*>&) const = 0;
     virtual bool empty() const = 0;
@@ -65,6 +75,8 @@ namespace OOFCanvas {
     virtual void lowerToBottom() const = 0;
 
     virtual void writeToPNG(const std::string&) const = 0;
+
+    virtual MemoryStats getMemoryStats() const = 0;
   };
 
   std::ostream &operator<<(std::ostream&, const CanvasLayer&);
@@ -30,17 +30,65 @@ namespace OOFCanvas {
     Cairo::RefPtr<Cairo::Context> context;
     OSCanvasImpl *canvas;
     std::vector<CanvasItem*> items;
+    // A layer can be a view of another layer, its model, which may
+    // be in a different canvas.  The view displays the model's items
+    // with its own canvas's transform, bitmap, and settings.  Its
+    // items list is a copy of the model's, which owns the items and
+    // keeps the copies up to date.  model is nullptr if the layer
+    // isn't a view, and views lists the views of a model.
+    CanvasLayerImpl *model;
+    std::vector<CanvasLayerImpl*> views;
     double alpha;
     bool visible;
     bool clickable;
     bool dirty;		// Is the surface or bounding box out of date?
+    bool opaque;	// Was every pixel opaque when the layer was rendered?
+    LayerFormat format;
+    Color tint;		// color of A8 layers
+    Cairo::Format cairoFormat() const;
+
+    // A hidden layer's bitmap may be released to save memory.  It's
+    // replaced by an empty bitmap, so that the context still has the
+    // layer's transform, and recreated when the layer is rendered.
+    // hiddenStamp orders the hidden layers by the time they were
+    // hidden.  See OSCanvasImpl::trimHiddenLayers.
+    bool bitmapReleased;
+    unsigned long hiddenStamp;
     mutable Rectangle bbox; // Cached bounding box of all contained items
     mutable Rectangle bare_bbox; // Cached bbox of all items if ppu=infinite
     mutable double pxhi, pxlo, pyhi, pylo; // Cached pixel extents
     void makeCairoObjs(int, int);
     mutable Lock layerlock; // Controls access to local context and surface
+
+    // If recordingEnabled is true, the items are drawn onto a Cairo
+    // recording surface and renderToContext replays the recording
+    // instead of drawing the items again.  See setRecording().
+    bool recordingEnabled;
+    mutable Cairo::RefPtr<Cairo::Surface> recording;
+    mutable Cairo::Matrix recordingMatrix; // user coords to recording coords
+    mutable bool recordingValid; // false if items have changed
+    mutable bool recordingPPUDependent; // true if any item dependsOnPPU()
+    mutable Cairo::Antialias recordingAntialias;
+    void drawItems(Cairo::RefPtr<Cairo::Context>) const;
+    bool recordingIsCurrent(Cairo::RefPtr<Cairo::Context>) const;
+    bool makeRecording(Cairo::RefPtr<Cairo::Context>) const;
+    void replayRecording(Cairo::RefPtr<Cairo::Context>) const;
+
+    // changeStamp is set to a new value, unique among all layers,
+    // whenever items are added, removed, or modified.  It lets
+    // FrameExporter tell which layers need to be redrawn.
+    unsigned long changeStamp;
+    // contentChanged invalidates the recording and marks the views as
+    // dirty.  contentChanged_nolock must be called with the layerlock
+    // held, because it reads the list of views.
+    void contentChanged();
+    void contentChanged_nolock();
+    // appearanceChanged updates the changeStamp when the layer will
+    // look different but its items and recording haven't changed.
+    void appearanceChanged();
   public:
-    CanvasLayerImpl(OSCanvasImpl*, const std::string&);
+    CanvasLayerImpl(OSCanvasImpl*, const std::string&,
+		    CanvasLayerImpl *model=nullptr);
     virtual ~CanvasLayerImpl();
 
     // Methods that need to be accessible through the public interface
@@ -75,6 +123,12 @@ namespace OOFCanvas {
     // the Canvas)
     virtual void copyToCanvas(Cairo::RefPtr<Cairo::Context>, double hadj,
 			      double vadj) const;
+    // paintImage draws an image of the layer, such as its surface,
+    // at the given offset with the layer's opacity.  If the layer's
+    // format is A8, the image's alpha channel is used as a mask for
+    // the tint color.
+    void paintImage(Cairo::RefPtr<Cairo::Context>,
+		    Cairo::RefPtr<Cairo::Surface>, double, double) const;
 
     // Layers can be removed from a Canvas by calling
     // Canvas::deleteLayer or CanvasLayerImpl::destroy.  The effect is the
@@ -84,7 +138,18 @@ namespace OOFCanvas {
     virtual void show();
     virtual void hide();
     bool isDirty() const { return dirty; }
-    void markDirty() { dirty = true; }
+    // isOpaque() is true if the layer's surface was completely
+    // covered by opaque items the last time it was rendered.
+    bool isOpaque() const {
+      return opaque && !dirty && (format != LayerFormat::A8 || tint.alpha == 1);
+    }
+    // markDirty() must be called when an item's appearance changes.
+    // It's called by CanvasItem::modified().  Changes to the
+    // transform set dirty directly, since they don't change the
+    // layer's recording.
+    void markDirty();
+    unsigned long getChangeStamp() const { return changeStamp; }
+    const CanvasLayerImpl *getModel() const { return model; }
 
     // Given the ppu, compute and cache the bounding box. It's not
     // recomputed if the cached value is current. The bool says
@@ -116,6 +181,28 @@ namespace OOFCanvas {
 
     virtual void setOpacity(double alph) { alpha = alph; }
 
+    // setRecording(true) makes the layer keep a Cairo recording
+    // surface containing the drawing commands for all of its items.
+    // The recording is made the first time the layer is drawn after
+    // items are added, removed, or modified, and is replayed when the
+    // layer is redrawn at a new ppu or exported with
+    // Canvas::saveAsPNG, saveAsPDF, or saveRegion.
+    virtual void setRecording(bool);
+
+    // setFormat sets the pixel format of the layer's bitmap, and
+    // setTint sets the color used to draw A8 layers.  The default is
+    // ARGB32.
+    virtual void setFormat(LayerFormat);
+    virtual void setTint(const Color&);
+    LayerFormat getFormat() const { return format; }
+    const Color &getTint() const { return tint; }
+
+    // releaseBitmap discards the bitmap of a hidden layer.
+    // bitmapBytes is the size of the bitmap, which is zero if it's
+    // been released.
+    void releaseBitmap();
+    std::size_t bitmapBytes() const;
+
     virtual void allItems(std::vector<CanvasItem*>&) const;
     virtual bool empty() const;
     virtual std::size_t size() const { return items.size(); } 
@@ -130,14 +217,26 @@ namespace OOFCanvas {
     Cairo::RefPtr<Cairo::Context> getContext() const { return context; }
 
     void datadump(std::ostream&) const;
+
+    // getMemoryStats reports the size of the layer's bitmap and the
+    // memory used by the items' cached paths.
+    virtual MemoryStats getMemoryStats() const;
     
     friend class CanvasItem;
     friend class GUICanvasImpl;
     friend class OSCanvasImpl;
+    friend class FrameExporterImpl;
+    friend class SceneWriter;
   };
 
   std::ostream &operator<<(std::ostream&, const CanvasLayerImpl&);
 
+  // paintLayerImage does the work of CanvasLayerImpl::paintImage for
+  // code that has copied the layer's settings.
+  void paintLayerImage(Cairo::RefPtr<Cairo::Context>,
+		       Cairo::RefPtr<Cairo::Surface>, double x, double y,
+		       double alpha, LayerFormat, const Color &tint);
+
 };
 
 #endif // OOFCANVAS_LAYER_IMPL_H
@@ -0,0 +1,106 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_MARKERS_H
+#define OOFCANVAS_MARKERS_H
+
+#include "oofcanvas/canvasitem.h"
+#include "oofcanvas/utility.h"
+#include <cstdint>
+#include <vector>
+
+namespace OOFCanvas {
+
+  // CanvasMarkers draws a filled disk at each of a large number of
+  // points.  It's much cheaper than creating a CanvasDot for each
+  // point.  The positions are stored in flat arrays, and each point
+  // can optionally have its own color and radius.  By default the
+  // radius is given in pixels, like a CanvasDot's, but it can also
+  // be given in user units.
+
+  // When the markers are drawn on a bitmap and their radii are in
+  // pixels, each disk is copied from a pre-rendered sprite directly
+  // into the bitmap, and its position is rounded to the nearest
+  // pixel.  Otherwise, for example when writing a pdf file, the
+  // disks are drawn with Cairo.
+
+  class CanvasMarkers : public CanvasItem {
+  protected:
+    std::vector<double> xs, ys;
+    // colors and radii are either empty, in which case all points
+    // use fillColor and radius, or have one entry per point.  Colors
+    // are packed as 8 bit RGBA values, red in the high byte.
+    std::vector<std::uint32_t> colors;
+    std::vector<double> radii;
+    Color fillColor;
+    double radius;
+    bool radiusInPixels;
+    double largestRadius;
+    // version is incremented whenever the points change, so that
+    // cached data in the implementation can be discarded.
+    unsigned long version;
+    void swallow(std::size_t);
+    void updateBBox();
+  public:
+    CanvasMarkers();
+    // Use this constructor if you know how many points you'll be
+    // adding.
+    CanvasMarkers(std::size_t n);
+    static CanvasMarkers *create() {
+      return new CanvasMarkers();
+    }
+    virtual const std::string &classname() const;
+
+    void setFillColor(const Color&);
+    void setRadius(double);	     // in user units
+    void setRadiusInPixels(double);
+    const Color &getFillColor() const { return fillColor; }
+    double getRadius() const { return radius; }
+    bool getRadiusInPixels() const { return radiusInPixels; }
+
+    void addPoint(const Coord&);
+    void addPoint(const Coord *pt) { addPoint(*pt); }
+    void addPoints(const std::vector<Coord>*);
+    // setPoints replaces all points, and discards per-point colors
+    // and radii.
+    void setPoints(std::size_t n, const double *x, const double *y);
+    void clear();
+    std::size_t size() const { return xs.size(); }
+    Coord getPoint(std::size_t i) const { return Coord(xs[i], ys[i]); }
+
+    // Per-point colors and radii.  setColors and setRadii take one
+    // value per point, and must be called after the points are
+    // added.  Calling them with an empty vector reverts to the
+    // default color or radius.  setPointColor and setPointRadius
+    // start with the default for all other points.
+    void setColors(const std::vector<Color>*);
+    void setRadii(const std::vector<double>*);
+    void setPointColor(std::size_t, const Color&);
+    void setPointRadius(std::size_t, double);
+    Color getPointColor(std::size_t) const;
+    double getPointRadius(std::size_t i) const {
+      return radii.empty() ? radius : radii[i];
+    }
+    double maxRadius() const { return largestRadius; }
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasMarkers&);
+    virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasMarkersImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasMarkers&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_MARKERS_H
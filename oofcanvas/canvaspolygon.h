@@ -29,10 +29,14 @@ namespace OOFCanvas {
     void addPoint(const Coord &);
     void addPoint(const Coord* p) { addPoint(*p); }
     void addPoints(const std::vector<Coord>*);
+    // Add n points stored as x0, y0, x1, y1, ...
+    void addPoints(const double *xy, std::size_t n);
     const std::vector<Coord>& getCorners() const { return corners; }
     std::size_t size() const { return corners.size(); }
     friend std::ostream &operator<<(std::ostream&, const CanvasPolygon&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
 
     int windingNumber(const Coord&) const;
   };
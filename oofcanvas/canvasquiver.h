@@ -0,0 +1,115 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_QUIVER_H
+#define OOFCANVAS_QUIVER_H
+
+#include "oofcanvas/canvasshape.h"
+#include "oofcanvas/utility.h"
+#include <vector>
+
+namespace OOFCanvas {
+
+  // CanvasQuiver draws a vector field as a set of arrows.  Each arrow
+  // starts at a position (x, y) and ends at (x + scale*u, y +
+  // scale*v).  The positions and vectors are stored in flat arrays,
+  // and the vectors can be replaced without reallocating anything,
+  // for fields that change in time.
+
+  // The shafts are drawn with the CanvasShape line style, and the
+  // heads are filled with the line color.  If a colormap is set, the
+  // arrows are colored by the magnitude of the vector instead.
+
+  // When the canvas is zoomed out so far that arrows are closer
+  // together than the thinning distance, only one arrow is drawn in
+  // each square of that size.
+
+  class CanvasQuiver : public CanvasShape {
+  protected:
+    std::vector<double> xs, ys, us, vs;
+    double scale;
+    double headWidth, headLength;
+    bool headPixelScaling;
+    double thinning;		// in pixels
+    std::vector<Color> colormap;
+    double magMin, magMax;	// used if magMin < magMax
+    // dataVersion is incremented when the positions, vectors, or
+    // thinning change, so that the implementation knows when to
+    // thin the arrows again.
+    unsigned long dataVersion;
+    void updateBBox();
+  public:
+    CanvasQuiver();
+    // Use this constructor if you know how many vectors you'll be
+    // adding.
+    CanvasQuiver(std::size_t n);
+    static CanvasQuiver *create() {
+      return new CanvasQuiver();
+    }
+    virtual const std::string &classname() const;
+
+    void addVector(const Coord &pos, const Coord &vec);
+    void addVector(const Coord *pos, const Coord *vec) {
+      addVector(*pos, *vec);
+    }
+    // setVectors sets all of the positions and vectors.  If n is the
+    // same as the current size, the existing arrays are reused.
+    void setVectors(std::size_t n, const double *x, const double *y,
+		    const double *u, const double *v);
+    // This version changes the vectors but not the positions.
+    void setVectors(const double *u, const double *v);
+    void setVectors(const std::vector<double> *u, const std::vector<double> *v);
+    void clear();
+    std::size_t size() const { return xs.size(); }
+    Coord getPosition(std::size_t i) const { return Coord(xs[i], ys[i]); }
+    Coord getVector(std::size_t i) const { return Coord(us[i], vs[i]); }
+
+    // The length of an arrow in user units is scale times the length
+    // of its vector.  The default is 1.
+    void setScale(double);
+    double getScale() const { return scale; }
+
+    // The size of the arrowheads is given in user units or pixels.
+    // The default is 6 pixels wide and 8 pixels long.
+    void setHeadSize(double width, double length);
+    void setHeadSizeInPixels(double width, double length);
+    double getHeadWidth() const { return headWidth; }
+    double getHeadLength() const { return headLength; }
+    bool getHeadPixelScaling() const { return headPixelScaling; }
+
+    // setThinning sets the minimum distance in pixels between drawn
+    // arrows.  The default is 4.  Zero draws all arrows.
+    void setThinning(double);
+    double getThinning() const { return thinning; }
+
+    // If a colormap is set, arrows are colored by magnitude.  The
+    // first color is used for magnitudes at or below the lower limit
+    // of the magnitude range and the last color for magnitudes at or
+    // above the upper limit.  If the range hasn't been set, the
+    // smallest and largest magnitudes are used.  An empty colormap
+    // turns off coloring by magnitude.
+    void setColormap(const std::vector<Color>&);
+    const std::vector<Color> &getColormap() const { return colormap; }
+    void setMagnitudeRange(double lo, double hi);
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasQuiver&);
+    virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasQuiverImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasQuiver&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_QUIVER_H
@@ -33,6 +33,8 @@ namespace OOFCanvas {
     double getYmax() const { return ymax; }
     friend std::ostream &operator<<(std::ostream &, const CanvasRectangle&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::ostream &operator<<(std::ostream &, const CanvasRectangle&);
@@ -0,0 +1,120 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_SCALARIMAGE_H
+#define OOFCANVAS_SCALARIMAGE_H
+
+#include "oofcanvas/canvasitem.h"
+#include "oofcanvas/utility.h"
+#include <vector>
+
+#ifdef OOFCANVAS_USE_NUMPY
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <Python.h>
+#include <numpy/arrayobject.h>
+#endif // OOFCANVAS_USE_NUMPY
+
+namespace OOFCanvas {
+
+  // A CanvasScalarImage displays a two dimensional array of numbers,
+  // such as a stress or phase field, by mapping each value to a color
+  // through a colormap.  It keeps the values, not the colors, so
+  // changing the colormap, the range of values, or the log scaling
+  // is cheap.  Only the part of the image that is visible is
+  // colored, and only at the resolution at which it's displayed.
+
+  // The values are stored by rows, with the top row first, like the
+  // pixels of a CanvasImage.  Values that are NaN are transparent.
+  // Values outside of the range are given the color at the nearest
+  // end of the range.
+
+  class CanvasScalarImage : public CanvasItem {
+  protected:
+    Coord location;		// lower-left corner in user coordinates
+    Coord size;			// in user units
+    ICoord pixels;		// number of values in each direction
+    std::vector<float> values;
+    std::vector<Color> colormap;
+    double vmin, vmax;
+    bool logScale;
+    double opacity;
+    // dataVersion is incremented when the values change, and
+    // mapVersion is incremented when the mapping from values to
+    // colors changes, so that the implementation knows when to
+    // recompute its colored image.
+    unsigned long dataVersion;
+    unsigned long mapVersion;
+    void dataChanged();
+    void mapChanged();
+  public:
+    CanvasScalarImage(const Coord &pos, const ICoord &npixels);
+    CanvasScalarImage(const CanvasScalarImage&) = delete;
+    static CanvasScalarImage *create(const Coord *pos, const ICoord *npix) {
+      return new CanvasScalarImage(*pos, *npix);
+    }
+    virtual const std::string &classname() const;
+
+    // The default size is one user unit per value.
+    void setSize(const Coord&);
+    void setSize(const Coord *sz) { setSize(*sz); }
+    const Coord &getSize() const { return size; }
+    const ICoord &getSizeInPixels() const { return pixels; }
+    const Coord &getLocation() const { return location; }
+
+    // setValues copies pixels.x*pixels.y values from the given array.
+    void setValues(const float*);
+    void setValues(const double*);
+    void setValues(const std::vector<double>*);
+    void setValue(const ICoord&, double);
+    void setValue(const ICoord *pt, double v) { setValue(*pt, v); }
+    double getValue(const ICoord&) const;
+    double getValue(const ICoord *pt) const { return getValue(*pt); }
+    const std::vector<float> &getValues() const { return values; }
+
+    // The colormap is a list of evenly spaced colors.  The first is
+    // used for vmin, the last for vmax, and intermediate values are
+    // interpolated.  The default is a gray scale from black to white.
+    void setColormap(const std::vector<Color>&);
+    const std::vector<Color> &getColormap() const { return colormap; }
+    void setRange(double vmin, double vmax);
+    // autoRange sets the range to the smallest and largest values
+    // that aren't NaN.  If logScale is set, non-positive values are
+    // ignored.
+    void autoRange();
+    double getMin() const { return vmin; }
+    double getMax() const { return vmax; }
+    void setLogScale(bool);
+    bool getLogScale() const { return logScale; }
+    void setOpacity(double);
+    double getOpacity() const { return opacity; }
+
+#ifdef OOFCANVAS_USE_NUMPY
+    // The numpy array must be two dimensional, and contain floats or
+    // integers.  If flipy is true, the first row of the array is the
+    // bottom row of the image.
+    static CanvasScalarImage *newFromNumpy(const Coord*, PyArrayObject*,
+					   bool flipy);
+    void setValuesFromNumpy(PyArrayObject*, bool flipy);
+#endif // OOFCANVAS_USE_NUMPY
+
+    friend std::ostream &operator<<(std::ostream&, const CanvasScalarImage&);
+    virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
+
+    friend class CanvasScalarImageImplementation;
+  };
+
+  std::ostream &operator<<(std::ostream&, const CanvasScalarImage&);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_SCALARIMAGE_H
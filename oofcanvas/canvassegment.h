@@ -36,6 +36,8 @@ namespace OOFCanvas {
     friend std::ostream &operator<<(std::ostream&, const CanvasSegment&);
     friend std::ostream &operator<<(std::ostream&, const CanvasArrowhead&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::ostream &operator<<(std::ostream &, const CanvasSegment&);
@@ -74,6 +76,8 @@ namespace OOFCanvas {
 
     friend std::ostream &operator<<(std::ostream&, const CanvasArrowhead&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::ostream &operator<<(std::ostream&, const CanvasArrowhead&);
@@ -32,12 +32,16 @@ namespace OOFCanvas {
     virtual const std::string &classname() const;
     void addSegment(const Coord&, const Coord&);
     void addSegment(const Coord *a, const Coord *b) { addSegment(*a, *b); }
+    // Add n segments stored as x0, y0, x1, y1 for each segment.
+    void addSegments(const double *xy, std::size_t n);
     const std::vector<Segment> &getSegments() const { return segments; }
     std::vector<Segment> &getSegments() { return segments; }
     void setPoint0(const Coord&); // sets pt0 of all segments
     std::size_t size() const { return segments.size(); }
     friend std::ostream &operator<<(std::ostream &, const CanvasSegments&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::ostream &operator<<(std::ostream &, const CanvasSegments&);
@@ -58,10 +62,14 @@ namespace OOFCanvas {
     void addPoint(const Coord&);
     void addPoint(const Coord *p) { addPoint(*p); }
     void addPoints(const std::vector<Coord>*);
+    // Add n points stored as x0, y0, x1, y1, ...
+    void addPoints(const double *xy, std::size_t n);
     const std::vector<Coord> &getPoints() const { return points; }
     std::size_t size() const { return points.size(); }
     friend std::ostream &operator<<(std::ostream&, const CanvasCurve&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::ostream &operator<<(std::ostream&, const CanvasCurve&);
@@ -14,6 +14,7 @@
 
 #include "oofcanvas/canvasitem.h"
 #include "oofcanvas/utility.h"
+#include <memory>
 #include <vector>
 
 namespace OOFCanvas {
@@ -23,8 +24,17 @@ namespace OOFCanvas {
   enum class LineCap {BUTT, ROUND, SQUARE};
   enum class LineJoin {MITER, ROUND, BEVEL};
   
-  class CanvasShape : public CanvasItem {
-  protected:
+  // CanvasShapeStyle contains the line and fill attributes of a
+  // CanvasShape.  Shapes can share a style (see
+  // CanvasShape::shareStyle()), which saves memory when many items
+  // look the same, and allows CanvasLayerImpl to draw consecutive
+  // items with the same style in a single batch.  A shape that
+  // changes its style while the style is shared gets its own copy of
+  // the style first, so other shapes aren't affected.
+
+  class CanvasShapeStyle {
+  public:
+    CanvasShapeStyle();
     double lineWidth;
     Color lineColor;
     Color dashColor;
@@ -34,9 +44,21 @@ namespace OOFCanvas {
     bool dashColorSet;
     int dashOffset;
     std::vector<double> dash;
-
     LineJoin lineJoin;
     LineCap lineCap;
+    // fillColor and fill are only used by CanvasFillableShapes.
+    Color fillColor;
+    bool fill;
+    bool operator==(const CanvasShapeStyle&) const;
+    bool operator!=(const CanvasShapeStyle &s) const { return !(*this == s); }
+  };
+  
+  class CanvasShape : public CanvasItem {
+  protected:
+    std::shared_ptr<CanvasShapeStyle> style;
+    // writableStyle() returns a style that can be modified without
+    // affecting other shapes.  It makes a copy if the style is shared.
+    CanvasShapeStyle &writableStyle();
   public:
     CanvasShape(CanvasItemImplBase *impl);
     virtual ~CanvasShape();
@@ -47,20 +69,20 @@ namespace OOFCanvas {
     virtual void setLineWidth(double);
     virtual void setLineWidthInPixels(double);
         
-    void setLineJoin(LineJoin lj) { lineJoin = lj; }
-    void setLineCap(LineCap lc) { lineCap = lc; }
-    LineCap getLineCap() const { return lineCap; }
-    LineJoin getLineJoin() const { return lineJoin; }
+    void setLineJoin(LineJoin lj);
+    void setLineCap(LineCap lc);
+    LineCap getLineCap() const { return style->lineCap; }
+    LineJoin getLineJoin() const { return style->lineJoin; }
 
-    bool lined() const { return line; }
+    bool lined() const { return style->line; }
 
     // getLineWidth() returns the value passed into setLineWidth() or
     // setLineWidthInPixels(), so it's not useful unless you know
     // which was used, which you can discover by calling
     // getLineWidthInPixels().  To get the actual line width, call
     // CanvasShapeImplementation::lineWidthInUserUnits() instead.
-    double getLineWidth() const { return lineWidth; }
-    bool getLineWidthInPixels() const { return lineWidthInPixels; }
+    double getLineWidth() const { return style->lineWidth; }
+    bool getLineWidthInPixels() const { return style->lineWidthInPixels; }
 
     // Calling setDash() makes the lines dashed.  The args are a
     // vector of dash lengths, and an offset into that vector.
@@ -77,31 +99,32 @@ namespace OOFCanvas {
     // blank.
     void setDashColor(const Color&);
     void unsetDashes();
-    const std::vector<double>& getDash() const { return dash; }
-    bool getDashLengthInPixels() const { return dashLengthInPixels; }
-    bool getDashColorSet() const { return dashColorSet; }
-    const Color &getDashColor() const { return dashColor; }
-    int getDashOffset() const { return dashOffset; }
+    const std::vector<double>& getDash() const { return style->dash; }
+    bool getDashLengthInPixels() const { return style->dashLengthInPixels; }
+    bool getDashColorSet() const { return style->dashColorSet; }
+    const Color &getDashColor() const { return style->dashColor; }
+    int getDashOffset() const { return style->dashOffset; }
+
+    const Color& getLineColor() const { return style->lineColor; }
+
+    // shareStyle() makes this shape use the same style object as the
+    // given shape.  Fill attributes are ignored by shapes that aren't
+    // CanvasFillableShapes.
+    void shareStyle(const CanvasShape*);
+    const CanvasShapeStyle *getStyle() const { return style.get(); }
 
-    const Color& getLineColor() const { return lineColor; }
+    friend class SceneReader;
   };
 
   class CanvasFillableShape : public CanvasShape {
-  protected:
-    Color fillColor;
-    bool fill;
   public:
     CanvasFillableShape(CanvasItemImplBase *impl)
-      : CanvasShape(impl),
-	fillColor(black),
-	fill(false)
-    {
-      line = false;
-    }
+      : CanvasShape(impl)
+    {}
     virtual ~CanvasFillableShape() {}
     virtual void setFillColor(const Color&);
-    const Color& getFillColor() const { return fillColor; }
-    bool filled() const { return fill; }
+    const Color& getFillColor() const { return style->fillColor; }
+    bool filled() const { return style->fill; }
   };
 
 };				// namespace OOFCanvas
@@ -15,9 +15,28 @@
 #include "oofcanvas/canvasitemimpl.h"
 #include "oofcanvas/canvasshape.h"
 #include <cairomm/cairomm.h>
+#include <vector>
 
 namespace OOFCanvas {
 
+  // Style functions that don't depend on the type of the CanvasShape.
+  // They're defined in canvasshape.C.
+  double lineWidthInUserUnits(const CanvasShapeStyle&,
+			      Cairo::RefPtr<Cairo::Context>);
+  std::vector<double> dashLengthInUserUnits(const CanvasShapeStyle&,
+					    Cairo::RefPtr<Cairo::Context>);
+  // strokeWithStyle sets line color, width, and dash pattern and
+  // strokes the current path.
+  void strokeWithStyle(const CanvasShapeStyle&, Cairo::RefPtr<Cairo::Context>);
+
+  // drawStyleRun draws a sequence of items that all have the given
+  // style and all return it from CanvasItemImplBase::batchStyle().
+  // It's used by CanvasLayerImpl::renderToContext.
+  void drawStyleRun(const CanvasShapeStyle&,
+		    std::vector<CanvasItem*>::const_iterator,
+		    std::vector<CanvasItem*>::const_iterator,
+		    Cairo::RefPtr<Cairo::Context>);
+
   template <class CANVASITEM>
   class CanvasShapeImplementation
     : public CanvasItemImplementation<CANVASITEM>
@@ -38,10 +57,24 @@ namespace OOFCanvas {
     // thickness is large compared to the size of the object the
     // answer will be incorrect.
     virtual void pixelExtents(double&, double&, double&, double&) const;    
+    // Dashes whose lengths are given in pixels depend on the ppu even
+    // though they don't affect pixelExtents.
+    virtual bool dependsOnPPU() const;
 
     // stroke sets line color, width, and dash pattern and draws the
     // lines.
     void stroke(Cairo::RefPtr<Cairo::Context>) const; 
+
+    // Shapes whose drawItem() just builds a single path with
+    // appendPath() and then strokes it can be drawn in batches (see
+    // CanvasItemImplBase::batchStyle()).  They should redefine
+    // batchStyle() to return batchableStyle().  A shape that can't be
+    // filled can't be batched if it's sharing a style with a filled
+    // shape.
+    const CanvasShapeStyle *batchableStyle() const {
+      const CanvasShapeStyle *style = this->canvasitem->getStyle();
+      return style->fill ? nullptr : style;
+    }
   };
 
   template <class CANVASITEM>
@@ -53,6 +86,11 @@ namespace OOFCanvas {
       : CanvasShapeImplementation<CANVASITEM>(item, bb)
     {}
     void fillAndStroke(Cairo::RefPtr<Cairo::Context> ctxt) const;
+    // Fillable shapes that can be batched use the style whether or
+    // not it's filled.
+    const CanvasShapeStyle *batchableStyle() const {
+      return this->canvasitem->getStyle();
+    }
   };
 
 };
@@ -48,6 +48,8 @@ namespace OOFCanvas {
 
     friend std::ostream &operator<<(std::ostream&, const CanvasText&);
     virtual std::string print() const;
+    virtual void writeScene(SceneWriter&) const;
+    static CanvasItem *readScene(SceneReader&);
   };
 
   std::vector<std::string> *list_fonts();
@@ -0,0 +1,87 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_COLORMAP_H
+#define OOFCANVAS_COLORMAP_H
+
+// Color utilities shared by the items that color their contents with
+// a colormap or with per-element colors.
+
+#include "oofcanvas/utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace OOFCanvas {
+
+  // Colors stored per element are packed into 32 bits, as RGBA with
+  // red in the high byte.
+  unsigned int colorByte(double);
+  std::uint32_t packColor(const Color&);
+  Color unpackColor(std::uint32_t);
+
+  // Convert a packed RGBA color to a premultiplied ARGB32 pixel, in
+  // Cairo's native endian format.
+  inline std::uint32_t premultiply(std::uint32_t c) {
+    const std::uint32_t a = c & 0xff;
+    const std::uint32_t r = ((c >> 24)*a + 127)/255;
+    const std::uint32_t g = (((c >> 16) & 0xff)*a + 127)/255;
+    const std::uint32_t b = (((c >> 8) & 0xff)*a + 127)/255;
+    return (a << 24) | (r << 16) | (g << 8) | b;
+  }
+
+  // colormapColor returns the color at position t in [0, 1] of a
+  // colormap, interpolating linearly between its evenly spaced
+  // colors.  t is clamped to [0, 1].
+  Color colormapColor(const std::vector<Color>&, double t);
+
+  // A colormap is sampled into a lookup table with colormapLUTSize
+  // premultiplied ARGB32 entries.  The entry after the last one is
+  // transparent, and is used for NaNs.  If colors is not null, it
+  // gets the unpremultiplied colors of the entries.
+  static const int colormapLUTSize = 1024;
+  void makeColormapLUT(const std::vector<Color>&, std::vector<std::uint32_t>&,
+		       std::vector<Color> *colors=nullptr);
+
+  // colorRowsInParallel calls colorRows(first, last) for bands of
+  // rows that together cover rows 0 through nrows-1.  The bands are
+  // colored in separate threads if the image has enough pixels.
+  void colorRowsInParallel(int nrows, int ncols,
+			   const std::function<void(int, int)> &colorRows);
+
+  // A RasterAxis places the pixels of an image along one axis.  Pixel
+  // k covers user coordinates origin + k*step to origin + (k+1)*step.
+  struct RasterAxis {
+    int npixels;
+    double origin, step;
+    double center(int k) const { return origin + (k + 0.5)*step; }
+  };
+
+  // deviceAxis returns an axis whose pixels are the device pixels
+  // that cover user coordinates uA to uB, which are at device
+  // coordinates dA and dB, cropped to the device coordinates clipLo
+  // to clipHi.  The pixels are anchored to the device, not to the
+  // clip region, so adjacent tiles of an image put their pixels at
+  // the same places.  The device transform must not rotate.
+  RasterAxis deviceAxis(double uA, double uB, double dA, double dB,
+			double clipLo, double clipHi);
+
+  // valueAxis returns an axis for n evenly spaced values or cells
+  // between user coordinates uA and uB.  Each pixel is a group of m
+  // of them, starting with the first, and the pixels are cropped to
+  // the ones between fractions fLo and fHi of the way from uA to uB.
+  RasterAxis valueAxis(int n, int m, double uA, double uB,
+		       double fLo, double fHi);
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_COLORMAP_H
@@ -0,0 +1,98 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_EXPORTJOB_H
+#define OOFCANVAS_EXPORTJOB_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace OOFCanvas {
+
+  // Callbacks for asynchronous exports.  The progress callback
+  // arguments are the fraction of the work that's been done and the
+  // data pointer that was passed to the export method.  The
+  // completion callback arguments are a flag indicating success, an
+  // error message (empty if successful), and the data pointer.
+  typedef void (*ExportProgressCallback)(double, void*);
+  typedef void (*ExportDoneCallback)(bool, const std::string&, void*);
+
+  // ExportJob is returned by OffScreenCanvas::saveAsPNGAsync and the
+  // other asynchronous export methods.  It runs the export on its own
+  // thread.  The caller owns the ExportJob.  Deleting it cancels the
+  // export if it hasn't finished, and waits for the thread to exit.
+  // If it's deleted on the export thread, by a callback that's run
+  // there, it doesn't wait, and the thread exits on its own.
+
+  class ExportJob {
+  public:
+    typedef std::function<void(double)> ProgressFn;
+    typedef std::function<void(bool, const std::string&)> DoneFn;
+    // Poster delivers callbacks to the thread on which they should be
+    // run.  The default runs them immediately on the export thread.
+    typedef std::function<void(const std::function<void()>&)> Poster;
+  private:
+    // The state of the job is shared with the export thread, which
+    // passes its own ExportJob to the export function.  That lets the
+    // caller's ExportJob be deleted while the thread is running.
+    struct State {
+      mutable std::mutex mutex;
+      std::condition_variable doneCondition;
+      double fraction;
+      bool done;
+      bool ok;
+      std::string errmsg;
+      std::atomic<bool> cancelRequested;
+      ProgressFn progressCB;
+      DoneFn doneCB;
+      Poster post;
+      double lastReported;
+    };
+    std::shared_ptr<State> state;
+    std::thread thread;
+    ExportJob(const std::shared_ptr<State> &state) : state(state) {}
+    void finish(bool, const std::string&);
+  public:
+    ExportJob(const ProgressFn&, const DoneFn&, const Poster&);
+    ~ExportJob();
+    ExportJob(const ExportJob&) = delete;
+    ExportJob &operator=(const ExportJob&) = delete;
+
+    // start() runs the given function on a new thread.  The function
+    // returns false if there was nothing to export, and reports
+    // errors by throwing CanvasException.
+    void start(const std::function<bool(ExportJob&)>&);
+    // Finish without starting a thread.
+    void finishNow(bool, const std::string&);
+
+    // Methods used by the export function.  setProgress() calls the
+    // progress callback, but not more often than once per percent.
+    // checkCancelled() throws an exception if cancel() was called.
+    void setProgress(double);
+    void checkCancelled() const;
+
+    // Methods for the caller.
+    void wait();
+    void cancel();
+    bool finished() const;
+    double progress() const;
+    bool succeeded() const;
+    std::string errorMessage() const;
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_EXPORTJOB_H
@@ -0,0 +1,68 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_FRAMEEXPORTER_H
+#define OOFCANVAS_FRAMEEXPORTER_H
+
+#include <string>
+
+namespace OOFCanvas {
+
+  class Coord;
+  class FrameExporterImpl;
+  class OffScreenCanvas;
+  class OSCanvasImpl;
+
+  // FrameExporter saves a sequence of PNG files showing the state of
+  // a canvas at different times, for making animations.  Each call
+  // to saveFrame() writes the next file.  The file names are made
+  // from a printf style pattern containing a single integer
+  // conversion, such as "frame%04d.png".  Every frame shows the same
+  // region of the canvas at the same size.
+  //
+  // Between frames, FrameExporter keeps the image of each layer, and
+  // only redraws the layers that have changed.  Frames are written to
+  // files on other threads while the program goes on to build the
+  // next frame.
+
+  class FrameExporter {
+  private:
+    FrameExporterImpl *impl;
+  public:
+    FrameExporter(OffScreenCanvas*, const std::string &pattern,
+		  int maxpix, bool drawBG);
+    // This version is for swig.
+    FrameExporter(OSCanvasImpl*, const std::string &pattern,
+		  int maxpix, bool drawBG);
+    // The destructor calls finish(), but discards any errors.
+    ~FrameExporter();
+    FrameExporter(const FrameExporter&) = delete;
+    FrameExporter &operator=(const FrameExporter&) = delete;
+
+    // setRegion sets the region of the canvas to export.  It can only
+    // be called before the first frame is saved.  If it's not called,
+    // the region is the bounding box of everything on the canvas when
+    // the first frame is saved.
+    void setRegion(const Coord&, const Coord&);
+    void setRegion(const Coord*, const Coord*);
+
+    // saveFrame draws the current state of the canvas and starts
+    // writing it to the next file.  It returns the file name.
+    std::string saveFrame();
+    // finish waits until all frames have been written.  If writing
+    // any of them failed, it throws a CanvasException.
+    void finish();
+    int nFrames() const;
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_FRAMEEXPORTER_H
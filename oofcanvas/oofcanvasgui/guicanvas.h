@@ -57,11 +57,19 @@ namespace OOFCanvas {
     void zoomAbout(const Coord*, double factor); // for python
     void zoomToFill();
     void center();
+    // In draft zoom mode, each zoom step just rescales the previous
+    // image, and the canvas is redrawn at full quality msec
+    // milliseconds after the last step.
+    void setDraftZoom(bool, int msec=250);
 
     Rectangle visibleRegion() const;
 
     void removeMouseCallback();
     MotionAllowed allowMotionEvents(MotionAllowed ma);
+    // When motion is coalesced, the mouse callback gets at most one
+    // motion event per frame, and at most maxRate per second if
+    // maxRate is positive.  Button events are not delayed.
+    void setMotionCoalescing(bool, double maxRate=0.0);
 
     void show();		// make gtk widgets visible
     void draw();		// draws all modified layers
@@ -17,6 +17,8 @@
 #include "oofcanvas/oofcanvasgui/guicanvaslayer.h"
 #include "oofcanvas/oofcanvasgui/rubberband.h"
 #include <gtk/gtk.h>
+#include <mutex>
+#include <vector>
 
 namespace OOFCanvas {
   class Canvas;
@@ -47,6 +49,20 @@ namespace OOFCanvas {
     bool mouseButtonHandler(GdkEventButton*);
     static bool motionCB(GtkWidget*, GdkEventMotion*, gpointer);
     bool mouseMotionHandler(GdkEventMotion*);
+    void doMotion(const ICoord&, guint);
+    // Coalesced motion events.  When coalesceMotion is true, motion
+    // events just record the latest pointer position, and a frame
+    // clock tick callback delivers it once per frame, or less often
+    // if maxMotionRate (deliveries per second) is positive.
+    bool coalesceMotion;
+    double maxMotionRate;
+    bool motionPending;
+    ICoord pendingMotionPixel;
+    guint pendingMotionState;
+    guint motionTickId;		// pending frame clock tick, or 0
+    gint64 lastMotionTime;	// frame time of the last delivery, in usec
+    static gboolean motionTickCB(GtkWidget*, GdkFrameClock*, gpointer);
+    void flushMotion();
     virtual void doCallback(const std::string&, const Coord&,
 			    int, bool, bool) = 0;
     // Scrollwheel
@@ -64,25 +80,116 @@ namespace OOFCanvas {
 
     static void destroyCB(GtkWidget*, gpointer);
     void destroyHandler();
+    // releaseLayout removes the callbacks that refer to this canvas
+    // from the widget and forgets the widget.  It must be called
+    // while the widget still exists.
+    void releaseLayout();
 
     static bool drawCB(GtkWidget*, Cairo::Context::cobject*, gpointer);
     bool drawHandler(Cairo::RefPtr<Cairo::Context>);
 
     virtual void setWidgetSize(int, int);
+
+    // Callbacks from asynchronous exports are run on the main thread.
+    virtual ExportJob::Poster exportCallbackPoster() const;
     
     // Machinery used to draw rubberbands quickly.
     WindowSizeCanvasLayer rubberBandLayer; // rubberband representation
-    Cairo::RefPtr<Cairo::ImageSurface> nonRubberBandBuffer;
     RubberBand *rubberBand;	   // the rubberband, or nullptr
-    Rectangle rubberBandBBox;	   // bounding box of the previous rubberband
     Coord mouseDownPt;		   // where the rubberband drawing started
-    bool nonRubberBandBufferFilled;
+    GdkRectangle rubberBandArea;   // window area of the last rubberband drawn
+    bool rubberBandAreaValid;
+    bool findRubberBandArea(double, double, GdkRectangle&) const;
+    bool damageRubberBand();
+
+    // windowComposite is a window sized image of the background and
+    // all of the layers (other than the rubberband) as they appear in
+    // the window.  compositeKey describes what was drawn in it, so
+    // that it's only rebuilt when something has changed.  If only the
+    // scroll position has changed, the old image is shifted into
+    // scrollBuffer, the newly exposed strips are drawn, and the two
+    // surfaces are swapped.
+    //
+    // baseComposite holds the bottom of the stack, the layers below
+    // the lowest one that changed the last time windowComposite was
+    // rebuilt, so that when an upper layer changes repeatedly the
+    // composite can be rebuilt by copying baseComposite and drawing
+    // just the layers above it.
+    //
+    // If a layer is opaque and covers the window, neither the layers
+    // below it nor the background are drawn.  compositeBottom is
+    // the index of that layer, or -1 if there isn't one.
+    struct CompositeLayerKey {
+      const CanvasLayerImpl *layer;
+      unsigned long stamp;
+      bool visible;
+      double alpha;
+      bool operator==(const CompositeLayerKey&) const;
+    };
+    struct CompositeKey {
+      std::vector<CompositeLayerKey> layers;
+      int width, height;
+      double hadj, vadj;
+      Cairo::Matrix transform;
+      Color bgColor;
+      Cairo::Antialias antialias;
+      CompositeKey();
+      bool operator==(const CompositeKey&) const;
+      // sameView compares everything but the layers.
+      bool sameView(const CompositeKey&) const;
+    };
+    Cairo::RefPtr<Cairo::ImageSurface> windowComposite;
+    Cairo::RefPtr<Cairo::ImageSurface> scrollBuffer;
+    CompositeKey compositeKey;
+    int compositeBottom;
+    Cairo::RefPtr<Cairo::ImageSurface> baseComposite;
+    bool baseValid;
+    int baseBottom;		// compositeBottom when the base was started
+    int baseTop;		// baseComposite contains layers below this
+    CompositeKey currentCompositeKey(double, double) const;
+    bool compositeIsCurrent(const CompositeKey&) const;
+    bool compositeCanScroll(const CompositeKey&) const;
+    bool layerCoversWindow(const CanvasLayerImpl*, const CompositeKey&) const;
+    int findOccludingLayer(const CompositeKey&);
+    void updateWindowComposite(const CompositeKey&, double, double);
+    void buildWindowComposite(const CompositeKey&, double, double);
+    void scrollWindowComposite(const CompositeKey&, double, double);
+    void drawLayers(Cairo::RefPtr<Cairo::Context>, int, int, int,
+		    double, double);
+
+    // Draft zooming.  While the user is zooming, the window shows the
+    // last full quality composite, scaled and shifted to the new
+    // view, instead of rendering the layers at every step.  When no
+    // zoom has happened for draftDelay milliseconds, the layers are
+    // rendered at full quality.
+    bool draftZoom;
+    int draftDelay;
+    bool draftActive;
+    guint draftTimeoutId;
+    void startDraft();
+    static gboolean draftTimeoutCB(gpointer);
+    void drawDraft(Cairo::RefPtr<Cairo::Context>, double, double);
 
     bool destroyed;
 
+    // Redraw scheduling.  draw() may be called many times, from any
+    // thread, before the widget is drawn.  The first call adds an
+    // idle callback, which asks the widget's frame clock for a tick,
+    // which queues one draw for the next frame.  Later calls do
+    // nothing until that draw has been queued.
+    std::mutex redrawLock;
+    guint redrawIdleId;		// pending idle callback, or 0
+    guint redrawTickId;		// pending frame clock tick, or 0
+    static gboolean redrawIdleCB(gpointer);
+    static gboolean redrawTickCB(GtkWidget*, GdkFrameClock*, gpointer);
+    void requestRedraw();
+    void cancelRedraw();
+    virtual void sceneEditsPosted();
+    virtual void viewModelChanged();
+
   public:
     GUICanvasImpl(double ppu);
-    virtual ~GUICanvasImpl() {}
+    virtual ~GUICanvasImpl();
 
     // widgetWidth and widgetHeight return the size of the widget,
     // in pixels.
@@ -94,13 +201,15 @@ namespace OOFCanvas {
     void zoomAbout(const Coord*, double factor); // for python
     void zoomToFill();
     void center();
+    void setDraftZoom(bool, int msec=250);
 
     Rectangle visibleRegion() const;
 
     MotionAllowed allowMotionEvents(MotionAllowed ma);
+    void setMotionCoalescing(bool, double maxRate=0.0);
 
     void show();		// make gtk widgets visible
-    void draw();		// draws all modified layers
+    virtual void draw();	// schedules drawing of modified layers
     
     GtkAdjustment *getHAdjustment() const;
     GtkAdjustment *getVAdjustment() const;
@@ -108,6 +217,8 @@ namespace OOFCanvas {
 
     void setRubberBand(RubberBand*);
     void removeRubberBand();
+
+    virtual MemoryStats getMemoryStats() const;
   };				// GUICanvasImpl
 
   //=\\=//
@@ -149,6 +260,10 @@ namespace OOFCanvas {
   class PythonCanvas : public GUICanvasImpl {
   private:
     bool destroyed;
+    // The Gtk.Layout that this canvas holds a reference to.  layout
+    // is set to nullptr if the widget is destroyed, but the reference
+    // still has to be released.
+    GtkWidget *pyLayout;
   protected:
     PyObject *mouseCallback;
     PyObject *mouseCallbackData;
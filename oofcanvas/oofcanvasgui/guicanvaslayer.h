@@ -15,17 +15,20 @@
 #include "oofcanvas/canvaslayerimpl.h"
 
 namespace OOFCanvas {
-  // A WindowSizeCanvasLayer is big enough to fill the Canvas's
-  // window, which may be bigger or smaller than the bounding box of
-  // its contents.
+  // A WindowSizeCanvasLayer is drawn in the Canvas's window
+  // coordinates, which may be bigger or smaller than the bounding box
+  // of its contents.  It doesn't have a surface of its own.  Its
+  // items are drawn straight into the window by drawToWindow, so that
+  // drawing them costs no more than the area that the window's
+  // clipping region allows.
   
   class WindowSizeCanvasLayer : public CanvasLayerImpl {
   public:
     WindowSizeCanvasLayer(OSCanvasImpl*, const std::string&);
-    virtual void rebuild();
-    virtual void render();
-    virtual void copyToCanvas(Cairo::RefPtr<Cairo::Context>, double, double)
-      const;
+    virtual void rebuild() {}
+    virtual void render() {}
+    // The last two arguments are the effective scroll adjustments.
+    void drawToWindow(Cairo::RefPtr<Cairo::Context>, double, double) const;
   };
 };
 
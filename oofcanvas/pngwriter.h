@@ -0,0 +1,68 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_PNGWRITER_H
+#define OOFCANVAS_PNGWRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace OOFCanvas {
+
+  // PNGBand is a horizontal band of a PNG image, filtered and
+  // compressed by PNGStreamWriter::encodeBand() and ready to be
+  // written by PNGStreamWriter::writeBand().
+
+  struct PNGBand {
+    std::vector<unsigned char> data; // raw deflate blocks
+    unsigned long adler;	     // adler32 checksum of the filtered rows
+    std::size_t rawLength;	     // number of filtered bytes
+  };
+
+  // PNGStreamWriter writes a PNG file one band of rows at a time, so
+  // that images that are too large to fit in a single Cairo
+  // ImageSurface, or in memory, can be saved.  The bands are
+  // compressed independently by encodeBand(), which can be called on
+  // any thread, and must be written in order by writeBand().  The
+  // compressed bands are concatenated into a single zlib stream, the
+  // way that pigz does it.
+
+  class PNGStreamWriter {
+  private:
+    FILE *file;
+    const std::string filename;
+    const int width, height;
+    int rowsWritten;
+    unsigned long adler;
+    bool headerWritten;
+    void write(const unsigned char*, std::size_t);
+    void writeChunk(const char*, const unsigned char*, std::size_t);
+  public:
+    PNGStreamWriter(const std::string &filename, int width, int height);
+    ~PNGStreamWriter();
+
+    // encodeBand converts nrows rows of Cairo ARGB32 data (native
+    // endian, premultiplied alpha, width*4 bytes per row) to
+    // non-premultiplied RGBA and compresses them.  lastBand must be
+    // true for the band at the bottom of the image.
+    static PNGBand encodeBand(const unsigned char *argb, int width,
+			      int nrows, bool lastBand);
+
+    void writeBand(const PNGBand&, int nrows);
+    // finish() writes the end of the file and closes it.  It's an
+    // error to call it before all of the rows have been written.
+    void finish();
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_PNGWRITER_H
@@ -16,11 +16,17 @@
 
 #include <Python.h>
 #include <string>
+#include "oofcanvas/exportjob.h"
 
 namespace OOFCanvas {
   std::string repr(PyObject*);
   void init_PyExceptionConverter(PyObject*);
   extern PyObject *pyExConverter;
+
+  // Convert Python callables to ExportJob callbacks.  None is
+  // converted to a null function.
+  ExportJob::ProgressFn pyExportProgressFn(PyObject*);
+  ExportJob::DoneFn pyExportDoneFn(PyObject*);
 };
 
 #endif // OOFCANVAS_USE_PYTHON
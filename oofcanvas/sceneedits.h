@@ -0,0 +1,63 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_SCENEEDITS_H
+#define OOFCANVAS_SCENEEDITS_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace OOFCanvas {
+
+  // A SceneEdit is a change to the layers or items of a canvas that's
+  // made on one thread and carried out on the thread that draws the
+  // canvas.
+
+  typedef std::function<void()> SceneEdit;
+
+  // SceneEditQueue is a lock-free queue of SceneEdits with any number
+  // of producers and one consumer.  Producers never wait for the
+  // consumer or for each other.  The consumer takes all of the queued
+  // edits at once and applies them in the order in which they were
+  // posted.
+
+  class SceneEditQueue {
+  private:
+    struct Node {
+      SceneEdit edit;
+      Node *next;
+    };
+    // The most recently posted edit.  Each node points to the one
+    // posted before it.
+    std::atomic<Node*> head;
+  public:
+    SceneEditQueue() : head(nullptr) {}
+    ~SceneEditQueue();
+    SceneEditQueue(const SceneEditQueue&) = delete;
+    SceneEditQueue &operator=(const SceneEditQueue&) = delete;
+
+    // post adds an edit to the queue, and returns true if the queue
+    // was empty.  It can be called from any thread.
+    bool post(SceneEdit&&);
+
+    // apply carries out all of the edits in the queue, and returns
+    // the number applied.  It must only be called by one thread at a
+    // time.  If an edit throws an exception, the rest are still
+    // applied, and then the first exception is rethrown.
+    std::size_t apply();
+
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_SCENEEDITS_H
@@ -0,0 +1,194 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_SCENEFILE_H
+#define OOFCANVAS_SCENEFILE_H
+
+// Binary scene files, written by OffScreenCanvas::saveScene and read
+// by OffScreenCanvas::loadScene.
+//
+// A scene file is a header followed by a sequence of records.  Every
+// record starts with a type and a payload length, and every field
+// within a payload is padded to a multiple of 8 bytes, so that the
+// file can be memory mapped and numbers and arrays of numbers can be
+// used where they lie.  Numbers are stored in the byte order of the
+// machine that wrote the file.  Files written on a machine with the
+// other byte order are rejected.
+//
+// The records are
+//   STYLE: a CanvasShapeStyle, written before the first item that
+//          uses it.  Styles are numbered in the order they appear.
+//   ITEM:  a CanvasItem, starting with its SceneItemType and the
+//          number of its style.  The rest of the payload is written
+//          by the item's writeScene method and read by its class's
+//          static readScene method.  Items are numbered in the order
+//          they appear.
+//   LAYER: a layer's name and settings and the numbers of its items,
+//          written after all of the layer's items.
+//   VIEW:  a layer that's a view of another layer in the same
+//          canvas.  It contains the view's name and settings and the
+//          position of its model in the sequence of LAYER and VIEW
+//          records.  Views of layers in other canvases aren't saved.
+//   CANVAS: the background color.
+//   END:   the end of the file.
+// Readers skip records with unknown types, so new record types can
+// be added without changing the version number.  Changing the
+// contents of an existing record requires a new version.
+//
+// Version 2 added the bitmap format and tint color to the LAYER and
+// VIEW records.
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "oofcanvas/canvasexception.h"
+#include "oofcanvas/utility.h"
+
+namespace OOFCanvas {
+
+  class CanvasItem;
+  class CanvasLayerImpl;
+  class CanvasShapeStyle;
+  class OSCanvasImpl;
+
+  const std::uint32_t sceneFileVersion = 2;
+
+  enum class SceneRecordType : std::uint32_t {
+    END = 0, STYLE = 1, ITEM = 2, LAYER = 3, CANVAS = 4, VIEW = 5
+  };
+
+  // Don't change the values of existing SceneItemTypes.
+  enum class SceneItemType : std::uint32_t {
+    CIRCLE = 1,
+    ELLIPSE = 2,
+    DOT = 3,
+    RECTANGLE = 4,
+    POLYGON = 5,
+    SEGMENT = 6,
+    SEGMENTS = 7,
+    CURVE = 8,
+    ARROWHEAD = 9,
+    TEXT = 10,
+    IMAGE = 11,
+    MARKERS = 12,
+    SCALARIMAGE = 13,
+    QUIVER = 14,
+    CELLGRID = 15,
+    CONTOURS = 16,
+    GROUP = 17
+  };
+
+  const std::uint32_t sceneNoStyle = 0xffffffff;
+
+  //=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//
+
+  class SceneWriter {
+  private:
+    FILE *file;
+    const std::string filename;
+    // Items are built in memory before being written, because an
+    // item may need to write another item that it refers to first.
+    // The last vector in the stack is the record being built.
+    std::vector<std::vector<unsigned char>> records;
+    std::set<const CanvasItem*> sceneItems;
+    std::map<const CanvasItem*, std::uint32_t> itemNumbers;
+    std::map<const CanvasShapeStyle*, std::uint32_t> styleNumbers;
+    void writeRaw(const void*, std::size_t);
+    void writeRecord(SceneRecordType, const std::vector<unsigned char>&);
+    void append(const void*, std::size_t);
+    std::uint32_t styleNumber(const CanvasShapeStyle*);
+    std::uint32_t writeItem(const CanvasItem*);
+  public:
+    SceneWriter(const std::string &filename, const OSCanvasImpl*);
+    ~SceneWriter();
+    void writeLayer(const CanvasLayerImpl*);
+    // writeView writes a layer that's a view of the layer that was
+    // or will be written in the given position.
+    void writeView(const CanvasLayerImpl*, std::uint32_t model);
+    void writeCanvas(const Color &bgColor);
+    void finish();
+
+    // Methods used by CanvasItem::writeScene.  beginItem must be
+    // called first.
+    void beginItem(SceneItemType, const CanvasShapeStyle *style=nullptr);
+    template <class T> void write(const T &x) {
+      static_assert(std::is_standard_layout<T>::value,
+		    "SceneWriter::write needs a plain data type");
+      append(&x, sizeof(T));
+    }
+    template <class T> void writeArray(const T *x, std::size_t n) {
+      static_assert(std::is_standard_layout<T>::value,
+		    "SceneWriter::writeArray needs a plain data type");
+      write<std::uint64_t>(n);
+      append(x, n*sizeof(T));
+    }
+    void writeBool(bool);
+    void writeString(const std::string&);
+    void writeRectangle(const Rectangle&);
+    // itemNumber writes the given item if it hasn't been written
+    // already, and returns its number.  The item must be in one of
+    // the canvas's layers.
+    std::uint32_t itemNumber(const CanvasItem*);
+    // memberNumber is like itemNumber, but is used for items that
+    // belong to another item, such as the contents of a CanvasGroup,
+    // instead of to a layer.
+    std::uint32_t memberNumber(const CanvasItem*);
+  };
+
+  //=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//=\\=//
+
+  class SceneReader {
+  private:
+    const unsigned char *pos;	// next byte to read
+    const unsigned char *end;	// end of the current record
+    std::vector<std::shared_ptr<CanvasShapeStyle>> styles;
+    std::vector<CanvasItem*> items;
+    std::map<std::uint32_t, CanvasItem*> memberOwners;
+    const unsigned char *skip(std::size_t);
+    void readStyle();
+    void readItem();
+  public:
+    SceneReader() : pos(nullptr), end(nullptr) {}
+    ~SceneReader();
+    void load(const std::string &filename, OSCanvasImpl*);
+
+    // Methods used by the readScene methods of the CanvasItem
+    // classes.  They return references to the data in the file, so
+    // they must be used before the next record is read.
+    template <class T> const T &read() {
+      return *reinterpret_cast<const T*>(skip(sizeof(T)));
+    }
+    template <class T> const T *readArray(std::size_t &n) {
+      n = read<std::uint64_t>();
+      if(n > std::size_t(end - pos)/sizeof(T))
+	throw CanvasException("Corrupt scene file: bad array length");
+      return reinterpret_cast<const T*>(skip(n*sizeof(T)));
+    }
+    bool readBool() { return read<std::uint64_t>() != 0; }
+    std::string readString();
+    Rectangle readRectangle();
+    CanvasItem *item(std::uint32_t) const;
+    // takeMember returns an item written by SceneWriter::memberNumber
+    // and gives it to its owner, which must delete it.  memberOwner
+    // returns the item that took the given item, or nullptr.
+    CanvasItem *takeMember(std::uint32_t, CanvasItem *owner);
+    CanvasItem *memberOwner(std::uint32_t) const;
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_SCENEFILE_H
@@ -0,0 +1,65 @@
+// -*- C++ -*-
+
+/* This software was produced by NIST, an agency of the U.S. government,
+ * and by statute is not subject to copyright in the United States.
+ * Recipients of this software assume all responsibilities associated
+ * with its operation, modification and maintenance. However, to
+ * facilitate maintenance we ask that before distributing modified
+ * versions of this software, you first contact the authors at
+ * oof_manager@nist.gov.
+ */
+
+#ifndef OOFCANVAS_SURFACEPOOL_H
+#define OOFCANVAS_SURFACEPOOL_H
+
+#include <cairomm/cairomm.h>
+#include <cstddef>
+#include <memory>
+
+namespace OOFCanvas {
+
+  // SurfacePool keeps the pixel buffers of discarded image surfaces
+  // so that they can be reused, instead of being freed and
+  // reallocated every time a layer's bitmap changes size.
+  //
+  // lease() returns an ordinary Cairo::ImageSurface whose pixels are
+  // in a buffer owned by the pool.  When the last reference to the
+  // surface goes away, the buffer is returned to the pool.  The
+  // surface may outlive the pool.  Buffers are grouped into size
+  // classes, each about 25% larger than the previous one, and a
+  // lease is satisfied by any idle buffer in its class.  The pixels
+  // of a leased surface are not initialized.
+  //
+  // Idle buffers are freed, largest first, when their total size
+  // exceeds the pool's budget, or when an allocation fails.  The
+  // buffer of a surface that has been passed to discard() is freed
+  // instead of being returned to the pool.
+
+  class SurfacePool {
+  private:
+    class State;
+    struct Lease;
+    static void endLease(void*);
+    std::shared_ptr<State> state;
+  public:
+    SurfacePool(std::size_t maxIdleBytes=defaultMaxIdleBytes);
+    SurfacePool(const SurfacePool&) = delete;
+    SurfacePool &operator=(const SurfacePool&) = delete;
+
+    Cairo::RefPtr<Cairo::ImageSurface> lease(Cairo::Format, int, int);
+    // discard() does nothing if the surface wasn't leased from a pool.
+    static void discard(const Cairo::RefPtr<Cairo::ImageSurface>&);
+
+    // setMaxIdleBytes sets the budget and frees idle buffers that
+    // don't fit in it.  trim(0) frees all idle buffers.
+    void setMaxIdleBytes(std::size_t);
+    void trim(std::size_t);
+    std::size_t idleBytes() const;
+    std::size_t leasedBytes() const;
+
+    static const std::size_t defaultMaxIdleBytes;
+  };
+
+};				// namespace OOFCanvas
+
+#endif // OOFCANVAS_SURFACEPOOL_H
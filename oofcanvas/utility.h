@@ -12,6 +12,7 @@
 #ifndef OOFCANVAS_UTIL_H
 #define OOFCANVAS_UTIL_H
 
+#include <cstddef>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -32,6 +33,11 @@ namespace OOFCanvas {
       red = c.red; green = c.green; blue = c.blue; alpha = c.alpha;
       return *this;
     }
+    bool operator==(const Color &c) const {
+      return (red == c.red && green == c.green && blue == c.blue &&
+	      alpha == c.alpha);
+    }
+    bool operator!=(const Color &c) const { return !(*this == c); }
     Color opacity(double) const;
   };
 
@@ -139,6 +145,10 @@ namespace OOFCanvas {
     bool initialized() const { return initialized_; }
     void swallow(const Coord&);
     void swallow(const Rectangle &rect);
+    // Swallow npts points, stored either as Coords or as x0, y0, x1,
+    // y1, ...
+    void swallow(const Coord *pts, std::size_t npts);
+    void swallow(const double *xy, std::size_t npts);
     void expand(double);
     void shift(const Coord&);
     void scale(double, double);
@@ -168,6 +178,26 @@ namespace OOFCanvas {
 
   std::ostream &operator<<(std::ostream&, const Rectangle&);
 
+  //=\\=//
+
+  // MemoryStats describes the memory used by the bitmaps and caches
+  // of a CanvasLayer or of a whole canvas.  It's returned by
+  // CanvasLayer::getMemoryStats() and OffScreenCanvas::getMemoryStats().
+  
+  class MemoryStats {
+  public:
+    MemoryStats();
+    std::size_t nItems;
+    std::size_t surfaceBytes;	// bitmaps
+    std::size_t nCachedPaths;	// items with cached Cairo paths
+    std::size_t pathCacheBytes;
+    std::size_t idleSurfaceBytes; // unused bitmaps kept for reuse
+    std::size_t totalBytes() const;
+    MemoryStats &operator+=(const MemoryStats&);
+  };
+
+  std::ostream &operator<<(std::ostream&, const MemoryStats&);
+
   //=\\=//
   
   template <class TYPE>